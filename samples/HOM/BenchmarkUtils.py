@@ -0,0 +1,91 @@
+#
+# Copyright (c) 2015
+#	Side Effects Software Inc.  All rights reserved.
+#
+# Redistribution and use of Houdini Development Kit samples in source and
+# binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. The name of Side Effects Software may not be used to endorse or
+#    promote products derived from this software without specific prior
+#    written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+# NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+# OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#----------------------------------------------------------------------------
+# Shared driver for the HOM benchmark scripts.
+#
+
+"""Command line handling and output shared by the hython benchmarks.
+
+Each benchmark script only defines how to time one run and the columns it
+reports, and passes those to main().  The rows are written as CSV or JSON,
+to a file or to stdout.
+
+@see @ref HOM/SOP_AgentSkinBenchmark.py, @ref HOM/SOP_ArrayAttribBenchmark.py, @ref HOM/SOP_StarBenchmark.py, @ref HOM/SOP_WaveBenchmark.py
+"""
+
+import csv
+import json
+import sys
+
+
+def addOutputArguments(parser):
+    """Add the --cooks, --format and --output options to a parser."""
+    parser.add_argument("--cooks", type=int, default=5)
+    parser.add_argument("--format", choices=("csv", "json"), default="csv")
+    parser.add_argument("--output")
+
+
+def writeRows(rows, fields, fmt, stream):
+    if fmt == "json":
+        json.dump(rows, stream, indent=4)
+        stream.write("\n")
+        return
+    writer = csv.DictWriter(stream, fieldnames=fields)
+    writer.writeheader()
+    for row in rows:
+        writer.writerow(row)
+
+
+def writeOutput(rows, fields, args):
+    """Write the rows to --output, or to stdout if it wasn't given."""
+    if args.output:
+        with open(args.output, "w") as f:
+            writeRows(rows, fields, args.format, f)
+    else:
+        writeRows(rows, fields, args.format, sys.stdout)
+
+
+def main(argv, doc, run, fields, name, counts):
+    """Run a benchmark over a list of sizes and write its rows.
+
+    run(hou, count, cooks) times one size and returns a list of rows.  The
+    sizes are given with --<name>, defaulting to counts.
+    """
+    import argparse
+    import hou
+
+    parser = argparse.ArgumentParser(description=doc.splitlines()[0])
+    parser.add_argument("--" + name,
+                        default=",".join(str(n) for n in counts))
+    addOutputArguments(parser)
+    args = parser.parse_args(argv)
+
+    rows = []
+    for count in [int(n) for n in getattr(args, name).split(",")]:
+        rows.extend(run(hou, count, args.cooks))
+        sys.stderr.write("%d %s done\n" % (count, name))
+
+    writeOutput(rows, fields, args)
+    return 0
@@ -0,0 +1,109 @@
+#
+# Copyright (c) 2015
+#	Side Effects Software Inc.  All rights reserved.
+#
+# Redistribution and use of Houdini Development Kit samples in source and
+# binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. The name of Side Effects Software may not be used to endorse or
+#    promote products derived from this software without specific prior
+#    written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+# NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+# OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#----------------------------------------------------------------------------
+# This script benchmarks the linear blend and dual quaternion methods of the
+# agent skinning SOP from hython.
+#
+
+"""Benchmark agent skinning on crowds of bouncy agents headless.
+
+Usage:
+    hython SOP_AgentSkinBenchmark.py [--agents n,n,...] [--cooks n]
+                                     [--format csv|json] [--output file]
+
+For each agent count, a grid of points is fed into an hdk_bouncyagent node
+and the agents are unpacked by an hdk_agentskin node.  The agent node is
+cooked before timing starts, so only skinning is measured.  The skinning
+node is cooked once to build its output topology and then --cooks times at
+successive frames, so every timed cook poses the agents and rewrites P.
+The median cook time and the resulting skinned vertices per second are
+reported for each method.
+
+SOP_BouncyAgent and SOP_AgentSkin must have been built with hcustom and be
+on HOUDINI_DSO_PATH.
+
+@see @ref SOP/SOP_AgentSkin.C, @ref SOP/SOP_BouncyAgent.C, @ref HOM/BenchmarkUtils.py
+"""
+
+import math
+import sys
+import time
+
+import BenchmarkUtils
+
+METHODS = ["linear", "dualquat"]
+
+AGENT_COUNTS = [100, 1000, 10000, 100000]
+
+FIELDS = ["method", "agents", "vertices", "cooks", "cook_time_s",
+          "vertices_per_s"]
+
+
+def runOne(hou, agents, cooks):
+    """Time both methods on a crowd of at least the given size."""
+    geo = hou.node("/obj").createNode("geo")
+    for child in geo.children():
+        child.destroy()
+
+    side = int(math.ceil(math.sqrt(agents)))
+    grid = geo.createNode("grid")
+    grid.parmTuple("size").set((side * 3.0, side * 3.0))
+    grid.parm("rows").set(side)
+    grid.parm("cols").set(side)
+
+    crowd = grid.createOutputNode("hdk_bouncyagent")
+    node = crowd.createOutputNode("hdk_agentskin")
+
+    rows = []
+    for method in METHODS:
+        node.parm("method").set(method)
+        hou.setFrame(1)
+        node.cook(force=True)
+
+        times = []
+        for i in range(cooks):
+            # Cook the agents outside of the timing, so that only the
+            # skinning node's own work is measured.
+            hou.setFrame(i + 2)
+            crowd.cook()
+            start = time.time()
+            node.cook()
+            times.append(time.time() - start)
+        times.sort()
+        median = times[len(times) // 2]
+
+        vertices = node.geometry().intrinsicValue("pointcount")
+        rows.append(dict(method=method, agents=side * side,
+                         vertices=vertices, cooks=cooks,
+                         cook_time_s="%.6f" % median,
+                         vertices_per_s="%.0f" % (vertices / median)
+                                        if median else ""))
+    geo.destroy()
+    return rows
+
+
+if __name__ == "__main__":
+    sys.exit(BenchmarkUtils.main(sys.argv[1:], __doc__, runOne, FIELDS,
+                                 "agents", AGENT_COUNTS))
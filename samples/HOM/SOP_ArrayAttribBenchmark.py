@@ -0,0 +1,101 @@
+#
+# Copyright (c) 2015
+#	Side Effects Software Inc.  All rights reserved.
+#
+# Redistribution and use of Houdini Development Kit samples in source and
+# binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. The name of Side Effects Software may not be used to endorse or
+#    promote products derived from this software without specific prior
+#    written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+# NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+# OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#----------------------------------------------------------------------------
+# This script benchmarks the per-point and parallel methods of the array
+# attribute SOP against each other from hython.
+#
+
+"""Benchmark the per-point and parallel array attribute paths headless.
+
+Usage:
+    hython SOP_ArrayAttribBenchmark.py [--points n,n,...] [--cooks n]
+                                       [--format csv|json] [--output file]
+
+For each point count, a grid is fed into an hdk_arrayattrib node that is
+cooked --cooks times with each method.  The first cook creates the array
+attribute, and every following cook appends to the arrays it finds on
+its input, so the input is a second hdk_arrayattrib node that builds the
+arrays once.  The median cook time and the resulting points per second
+are reported for each method.
+
+SOP_ArrayAttrib must have been built with hcustom and be on
+HOUDINI_DSO_PATH.
+
+@see @ref SOP/SOP_ArrayAttrib.C, @ref HOM/BenchmarkUtils.py
+"""
+
+import math
+import sys
+import time
+
+import BenchmarkUtils
+
+METHODS = ["perpoint", "bulk"]
+
+POINT_COUNTS = [10000, 100000, 1000000, 5000000]
+
+FIELDS = ["method", "points", "cooks", "cook_time_s", "points_per_s"]
+
+
+def runOne(hou, points, cooks):
+    """Time both methods on a grid with at least the given point count."""
+    geo = hou.node("/obj").createNode("geo")
+    for child in geo.children():
+        child.destroy()
+
+    side = int(math.ceil(math.sqrt(points)))
+    grid = geo.createNode("grid")
+    grid.parm("rows").set(side)
+    grid.parm("cols").set(side)
+
+    # Give every point an array to start from, so both methods read and
+    # write non-empty arrays.
+    arrays = grid.createOutputNode("hdk_arrayattrib")
+    arrays.parm("attribname").set("neighbours")
+    node = arrays.createOutputNode("hdk_arrayattrib")
+    node.parm("attribname").set("neighbours")
+    arrays.cook(force=True)
+
+    rows = []
+    for method in METHODS:
+        node.parm("method").set(method)
+        times = []
+        for i in range(cooks):
+            start = time.time()
+            node.cook(force=True)
+            times.append(time.time() - start)
+        times.sort()
+        median = times[len(times) // 2]
+        rows.append(dict(method=method, points=side * side, cooks=cooks,
+                         cook_time_s="%.6f" % median,
+                         points_per_s="%.0f" % (side * side / median)
+                                      if median else ""))
+    geo.destroy()
+    return rows
+
+
+if __name__ == "__main__":
+    sys.exit(BenchmarkUtils.main(sys.argv[1:], __doc__, runOne, FIELDS,
+                                 "points", POINT_COUNTS))
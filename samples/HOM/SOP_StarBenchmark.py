@@ -0,0 +1,104 @@
+#
+# Copyright (c) 2015
+#	Side Effects Software Inc.  All rights reserved.
+#
+# Redistribution and use of Houdini Development Kit samples in source and
+# binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. The name of Side Effects Software may not be used to endorse or
+#    promote products derived from this software without specific prior
+#    written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+# NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+# OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#----------------------------------------------------------------------------
+# This script benchmarks the parallel and per-point paths of the star SOP
+# from hython.
+#
+
+"""Benchmark building large stars headless.
+
+Usage:
+    hython SOP_StarBenchmark.py [--points n,n,...] [--cooks n]
+                                [--format csv|json] [--output file]
+
+For each point count, an hdk_star node is cooked --cooks times with forced
+cooks, and the median cook time and resulting points per second are
+reported for both of its paths.  The "parallel" path uses constant radii,
+so the positions are computed in parallel.  The "local" path sets the radii
+to expressions that use $PT, without changing their values, so that the
+radii are evaluated point by point as before.
+
+SOP_Star must have been built with hcustom and be on HOUDINI_DSO_PATH.
+
+@see @ref SOP/SOP_Star.C, @ref HOM/BenchmarkUtils.py
+"""
+
+import sys
+import time
+
+import BenchmarkUtils
+
+# Radius expressions for each path.  Both give the default radii of the
+# star, but the local ones have to be evaluated for every point.
+PATHS = [
+    ("parallel", None),
+    ("local",    ("1 + 0 * $PT", "0.3 + 0 * $PT")),
+]
+
+POINT_COUNTS = [1000, 10000, 100000, 1000000, 10000000]
+
+FIELDS = ["path", "points", "cooks", "cook_time_s", "points_per_s"]
+
+
+def runOne(hou, points, cooks):
+    """Time both paths on a star with the given number of points."""
+    geo = hou.node("/obj").createNode("geo")
+    for child in geo.children():
+        child.destroy()
+
+    node = geo.createNode("hdk_star")
+    # The star has two points per division.
+    node.parm("divs").set(max(points // 2, 2))
+
+    rows = []
+    for name, expressions in PATHS:
+        radii = node.parmTuple("rad")
+        radii.deleteAllKeyframes()
+        radii.set((1, 0.3))
+        if expressions:
+            for parm, expr in zip(radii, expressions):
+                parm.setExpression(expr, hou.exprLanguage.Hscript)
+        node.cook(force=True)
+
+        times = []
+        for i in range(cooks):
+            start = time.time()
+            node.cook(force=True)
+            times.append(time.time() - start)
+        times.sort()
+        median = times[len(times) // 2]
+
+        count = node.geometry().intrinsicValue("pointcount")
+        rows.append(dict(path=name, points=count, cooks=cooks,
+                         cook_time_s="%.6f" % median,
+                         points_per_s="%.0f" % (count / median)
+                                      if median else ""))
+    geo.destroy()
+    return rows
+
+
+if __name__ == "__main__":
+    sys.exit(BenchmarkUtils.main(sys.argv[1:], __doc__, runOne, FIELDS,
+                                 "points", POINT_COUNTS))
@@ -0,0 +1,230 @@
+#
+# Copyright (c) 2015
+#	Side Effects Software Inc.  All rights reserved.
+#
+# Redistribution and use of Houdini Development Kit samples in source and
+# binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. The name of Side Effects Software may not be used to endorse or
+#    promote products derived from this software without specific prior
+#    written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+# NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+# OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+# EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#----------------------------------------------------------------------------
+# This script benchmarks the different implementations of the wave SOP
+# against each other from hython.
+#
+
+"""Benchmark every implementation of the wave deformer headless.
+
+Usage:
+    hython SOP_WaveBenchmark.py [--variants a,b,...] [--points n,n,...]
+                                [--cooks n] [--timeout seconds]
+                                [--format csv|json] [--output file]
+
+Each (variant, point count) pair is run in its own hython process so that
+the peak resident memory reported for it is not polluted by earlier runs.
+The input is a grid with the requested number of points, cooked before
+timing starts so that only the wave node itself is measured.  The node is
+then cooked --cooks times at successive frames and the median cook time is
+reported along with the resulting points per second.
+
+The C++ variants (hdk_pointwave, cpp_wave and hom_wave) and the HOM
+extension used by SOP_HOMWaveNumpyBuffers.py (Geometry_attribBuffers.C)
+must have been built with hcustom and be on HOUDINI_DSO_PATH.  The Python
+variants are loaded into Python SOPs from the .py files next to this
+script, and the VEX variant is compiled from ../SOP/SOP_VEXWave.vfl with
+vcc.  Variants that cannot be created are reported with a "missing"
+status rather than aborting the whole run.
+
+@see @ref HOM/SOP_HOMWave.py, @ref HOM/SOP_HOMWaveNumpy.py, @ref HOM/SOP_HOMWaveInlinecpp.py, @ref HOM/SOP_HOMWave.C, @ref SOP/SOP_CPPWave.C, @ref SOP/SOP_PointWave.C, @ref SOP/SOP_VEXWave.vfl, @ref HOM/BenchmarkUtils.py
+"""
+
+import json
+import math
+import os
+import resource
+import subprocess
+import sys
+import tempfile
+import time
+
+import BenchmarkUtils
+
+SAMPLES_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Name of each variant, mapped to how its node is created.  "dso" variants
+# are node types registered by a compiled HDK sample, "python" variants are
+# Python SOPs whose code is read from a file, and "vex" is a VEX SOP type
+# compiled from a .vfl file.
+VARIANTS = [
+    ("SOP_PointWave",         "dso",    "hdk_pointwave"),
+    ("SOP_CPPWave",           "dso",    "cpp_wave"),
+    ("SOP_HOMWave.C",         "dso",    "hom_wave"),
+    ("SOP_HOMWave.py",        "python", "HOM/SOP_HOMWave.py"),
+    ("SOP_HOMWaveNumpy.py",   "python", "HOM/SOP_HOMWaveNumpy.py"),
+    ("SOP_HOMWaveNumpyBuffers.py", "python",
+                              "HOM/SOP_HOMWaveNumpyBuffers.py"),
+    ("SOP_HOMWaveInlinecpp.py", "python", "HOM/SOP_HOMWaveInlinecpp.py"),
+    ("SOP_VEXWave.vfl",       "vex",    "SOP/SOP_VEXWave.vfl"),
+]
+
+POINT_COUNTS = [1000, 10000, 100000, 1000000, 10000000, 50000000]
+
+FIELDS = ["variant", "points", "status", "cooks", "cook_time_s",
+          "points_per_s", "peak_rss_mb"]
+
+
+def peakRSSMegabytes():
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform == "darwin":
+        rss /= 1024.0
+    return rss / 1024.0
+
+
+def createVariantNode(hou, parent, kind, source):
+    """Create the wave node for one variant below the given input."""
+    if kind == "dso":
+        return parent.createOutputNode(source)
+
+    path = os.path.join(SAMPLES_DIR, source)
+    if kind == "python":
+        node = parent.createOutputNode("python")
+        with open(path) as f:
+            node.parm("python").set(f.read())
+        return node
+
+    # Compile the VEX function into an operator type library that defines
+    # a VEX SOP, then install it into this session.
+    otl = os.path.join(tempfile.mkdtemp(), "vex_wave.otl")
+    subprocess.check_call(["vcc", "-l", otl, path])
+    hou.hda.installFile(otl)
+    return parent.createOutputNode("vex_wave")
+
+
+def runOne(name, points, cooks):
+    """Run a single benchmark in this process and return its result row."""
+    import hou
+
+    kind, source = [(k, s) for n, k, s in VARIANTS if n == name][0]
+    row = dict(variant=name, points=points, status="ok", cooks=0,
+               cook_time_s="", points_per_s="", peak_rss_mb="")
+
+    geo = hou.node("/obj").createNode("geo")
+    for child in geo.children():
+        child.destroy()
+
+    # A square grid with at least the requested number of points.
+    side = int(math.ceil(math.sqrt(points)))
+    grid = geo.createNode("grid")
+    grid.parmTuple("size").set((side * 0.1, side * 0.1))
+    grid.parm("rows").set(side)
+    grid.parm("cols").set(side)
+    row["points"] = side * side
+
+    try:
+        node = createVariantNode(hou, grid, kind, source)
+    except (hou.OperationFailed, subprocess.CalledProcessError, OSError):
+        row["status"] = "missing"
+        return row
+
+    grid.cook(force=True)
+
+    times = []
+    for i in range(cooks):
+        hou.setFrame(i + 1)
+        start = time.time()
+        node.cook(force=True)
+        times.append(time.time() - start)
+        if node.errors():
+            row["status"] = "error"
+            return row
+
+    times.sort()
+    median = times[len(times) // 2]
+    row["cooks"] = cooks
+    row["cook_time_s"] = "%.6f" % median
+    row["points_per_s"] = "%.0f" % (row["points"] / median) if median else ""
+    row["peak_rss_mb"] = "%.1f" % peakRSSMegabytes()
+    return row
+
+
+def runAll(variants, counts, cooks, timeout):
+    """Run every (variant, point count) pair in a fresh hython process."""
+    rows = []
+    for name in variants:
+        for points in counts:
+            cmd = [sys.executable, os.path.abspath(__file__),
+                   "--run", name, str(points), "--cooks", str(cooks)]
+            row = dict(variant=name, points=points, status="timeout",
+                       cooks=0, cook_time_s="", points_per_s="",
+                       peak_rss_mb="")
+
+            # Poll rather than using a subprocess timeout so this also runs
+            # under the Python 2 hython.  Output goes to a file so a chatty
+            # child can never block on a full pipe.
+            out = tempfile.TemporaryFile()
+            proc = subprocess.Popen(cmd, stdout=out)
+            deadline = time.time() + timeout
+            while proc.poll() is None and time.time() < deadline:
+                time.sleep(0.1)
+            if proc.poll() is None:
+                proc.kill()
+                proc.wait()
+            else:
+                out.seek(0)
+                lines = out.read().decode().strip().splitlines()
+                try:
+                    row = json.loads(lines[-1])
+                except (ValueError, IndexError):
+                    row["status"] = "failed"
+            out.close()
+            rows.append(row)
+            sys.stderr.write("%(variant)s %(points)s: %(status)s\n" % row)
+    return rows
+
+
+def main(argv):
+    import argparse
+
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--variants",
+                        default=",".join(n for n, k, s in VARIANTS))
+    parser.add_argument("--points",
+                        default=",".join(str(n) for n in POINT_COUNTS))
+    parser.add_argument("--timeout", type=float, default=600)
+    BenchmarkUtils.addOutputArguments(parser)
+    parser.add_argument("--run", nargs=2, help=argparse.SUPPRESS)
+    args = parser.parse_args(argv)
+
+    if args.run:
+        row = runOne(args.run[0], int(args.run[1]), args.cooks)
+        sys.stdout.write(json.dumps(row) + "\n")
+        return 0
+
+    variants = args.variants.split(",")
+    unknown = set(variants) - set(n for n, k, s in VARIANTS)
+    if unknown:
+        parser.error("unknown variants: %s" % ", ".join(sorted(unknown)))
+
+    counts = [int(n) for n in args.points.split(",")]
+    rows = runAll(variants, counts, args.cooks, args.timeout)
+    BenchmarkUtils.writeOutput(rows, FIELDS, args)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2015
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of Houdini Development Kit samples in source and
+ * binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *----------------------------------------------------------------------------
+ *
+ * The AgentSkin SOP
+ *
+ * Unpacks agent primitives into their skinned geometry.
+ *
+ */
+
+
+#ifndef __SOP_AGENTSKIN_H_INCLUDED__
+#define __SOP_AGENTSKIN_H_INCLUDED__
+
+#include <SOP/SOP_Node.h>
+#include <PRM/PRM_Template.h>
+#include <UT/UT_Array.h>
+#include <UT/UT_Matrix4.h>
+#include <UT/UT_Vector3.h>
+#include <SYS/SYS_Types.h>
+
+
+class GU_Agent;
+class GU_AgentRig;
+
+
+namespace HDK_Sample
+{
+
+/// The capture data of one deforming shape, flattened into arrays so that
+/// it can be read without going through the attribute interfaces. Every
+/// point has the same number of entries; unused entries have zero weight.
+class SOP_AgentSkinShape
+{
+public:
+			     SOP_AgentSkinShape()
+				: myUniqueId(-1)
+				, myPDataId(-1)
+				, myCaptureDataId(-1)
+				, myEntries(0)
+			     {}
+
+    /// Rebuild the tables from the shape geometry if it has changed since
+    /// they were last built. Returns false if the shape has no capture
+    /// weights.
+    bool		     update(const GU_Detail &shape,
+				    const GU_AgentRig &rig);
+
+    exint		     numPoints() const { return myRest.entries(); }
+    int			     numRegions() const { return myJoints.entries(); }
+
+    int			     myUniqueId;
+    int64		     myPDataId;
+    int64		     myCaptureDataId;
+
+    /// Rest positions, in point order.
+    UT_Array<UT_Vector3F>    myRest;
+    /// Region index and weight of each point's capture entries, stored as
+    /// myEntries consecutive values per point.
+    UT_Array<int>	     myRegions;
+    UT_Array<fpreal32>	     myWeights;
+    int			     myEntries;
+    /// Inverse rest transform and rig transform index of each region. The
+    /// index is -1 for regions whose transform isn't in the rig.
+    UT_Array<UT_Matrix4F>    myInvRest;
+    UT_Array<int>	     myJoints;
+};
+
+class SOP_AgentSkin : public SOP_Node
+{
+public:
+			     SOP_AgentSkin(
+				    OP_Network *net,
+				    const char *name,
+				    OP_Operator *op);
+    virtual		    ~SOP_AgentSkin();
+
+    static PRM_Template	     myTemplateList[];
+    static OP_Node	    *myConstructor(
+				    OP_Network*, const char*, OP_Operator*);
+
+protected:
+
+    /// Method to provide input labels
+    virtual const char	    *inputLabel(unsigned input_index) const;
+
+    /// Method to cook geometry for the SOP
+    virtual OP_ERROR	     cookMySop(OP_Context &context);
+
+private:
+
+    /// One deforming shape of one agent, and where its points start in our
+    /// output geometry.
+    class Piece
+    {
+    public:
+	exint		     myAgent;
+	int		     myShape;
+	GA_Offset	     myStart;
+    };
+
+    /// Gather the agents and deforming shapes from the input. Returns true
+    /// if the output topology no longer matches them.
+    bool		     gatherPieces(const GU_Detail &src);
+    /// Rebuild the output geometry as one copy of the shape per piece.
+    void		     buildTopology();
+
+    int			     METHOD() const
+				    { return evalInt("method", 0, 0); }
+
+private:
+    UT_Array<const GU_Agent *>		 myAgents;
+    UT_Array<UT_Matrix4F>		 myAgentXforms;
+
+    UT_Array<Piece>			 myPieces;
+    /// Unique ids of the shape of each piece when the topology was built.
+    UT_Array<int>			 myPieceShapeIds;
+
+    UT_Array<const GU_Detail *>		 myShapeDetails;
+    UT_Array<SOP_AgentSkinShape *>	 myShapes;
+};
+
+} // End HDK_Sample namespace
+
+#endif // __SOP_AGENTSKIN_H_INCLUDED__
@@ -47,6 +47,7 @@ protected:
 
     void	ATTRIBNAME(UT_String &str, fpreal t)
 					{ evalString(str, 0, 0, t); }
+    int		METHOD(fpreal t)	{ return evalInt("method", 0, t); }
 };
 } // End HDK_Sample namespace
 
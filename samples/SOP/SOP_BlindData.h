@@ -31,9 +31,56 @@
 #define __SOP_BlindData_h__
 
 #include <SOP/SOP_Node.h>
+#include <UT/UT_Array.h>
 #include <UT/UT_IStream.h>
+#include <UT/UT_Lock.h>
 
 namespace HDK_Sample {
+
+/// Container for a blind data payload as it's stored in the hip file.
+/// The payload is split into fixed size chunks, each compressed on its own
+/// with a small LZ codec, behind a header with a schema version and a
+/// checksum of the whole payload.
+///
+/// Loading only reads the compressed chunks.  They are decompressed and
+/// checked the first time the payload is asked for, and a blob that was
+/// never accessed is saved again without being recompressed.  A blob that
+/// can't be read, or turns out to be corrupt, is also saved exactly as it
+/// was loaded, so that the user's data isn't replaced until setData().
+///
+/// getData() may be called from several threads at once.  setData(),
+/// load() and save() must not run at the same time as anything else.
+class SOP_BlindDataBlob
+{
+public:
+	     SOP_BlindDataBlob();
+
+    void		 setData(const char *data, exint size);
+
+    /// Returns the payload, decoding it first if it was loaded and hasn't
+    /// been accessed yet.  Returns NULL if the stored data is corrupt.
+    const UT_Array<char> *getData();
+
+    bool		 save(std::ostream &os) const;
+    bool		 load(UT_IStream &is);
+
+private:
+    /// Not thread-safe; getData() serializes the calls.
+    bool		 decode();
+
+    UT_Array<char>	 myData;
+    UT_Array<char>	 myPacked;	// The whole packet, as loaded
+    exint		 myPackedStart;	// First compressed chunk in myPacked
+    UT_Array<int32>	 myChunkCodec;
+    UT_Array<int32>	 myChunkRawSize;
+    UT_Array<int32>	 myChunkPackedSize;
+    exint		 myRawSize;
+    uint32		 myChecksum;
+    bool		 myPending;	// Loaded but not decoded yet
+    bool		 myCorrupt;
+    UT_Lock		 myDecodeLock;
+};
+
 class SOP_BlindData : public SOP_Node
 {
 public:
@@ -44,6 +91,12 @@ public:
     static OP_Node		*myConstructor(OP_Network*, const char *,
 							    OP_Operator *);
 
+    /// The private data saved with this node.  It is only decompressed
+    /// the first time it is asked for after loading.
+    const UT_Array<char>	*getBlindData() { return myBlob.getData(); }
+    void			 setBlindData(const char *data, exint size)
+				 { myBlob.setData(data, size); }
+
 protected:
     virtual const char          *inputLabel(unsigned idx) const;
     virtual OP_ERROR		 cookMySop(OP_Context &context);
@@ -55,7 +108,10 @@ protected:
 private:
 
     int			loadPrivateData(UT_IStream &is);
+    int			loadLegacyPrivateData(UT_IStream &is);
     int			savePrivateData(std::ostream &os, int binary);
+
+    SOP_BlindDataBlob	myBlob;
 };
 } // End HDK_Sample namespace
 
@@ -38,6 +38,7 @@
 #include <PRM/PRM_Template.h>
 #include <GU/GU_AgentDefinition.h>
 #include <UT/UT_Array.h>
+#include <SYS/SYS_Hash.h>
 #include <SYS/SYS_Types.h>
 
 
@@ -47,6 +48,30 @@ class GU_PrimPacked;
 namespace HDK_Sample
 {
 
+/// The values that the procedural agent definition is built from. SOPs whose
+/// keys compare equal share a single definition.
+class SOP_BouncyAgentKey
+{
+public:
+			     SOP_BouncyAgentKey()
+				: myHeight(0)
+				, myRate(0)
+				, mySamples(0)
+			     {}
+
+    SYS_HashType	     hash() const;
+    bool		     operator==(const SOP_BouncyAgentKey &key) const
+				{
+				    return myHeight == key.myHeight
+					&& myRate == key.myRate
+					&& mySamples == key.mySamples;
+				}
+
+    fpreal		     myHeight;	// bounce height
+    fpreal		     myRate;	// clip sample rate
+    int			     mySamples;	// clip length in samples
+};
+
 class SOP_BouncyAgent : public SOP_Node
 {
 public:
@@ -70,7 +95,10 @@ protected:
 
 private:
 
-    GU_AgentDefinitionPtr    createDefinition(fpreal t) const;
+    /// Evaluate the parameters that the agent definition depends on.
+    SOP_BouncyAgentKey	     getDefinitionKey(fpreal t) const;
+    /// Let go of our reference to the shared agent definition.
+    void		     releaseDefinition();
 
     void		     AGENTNAME(UT_String &s, fpreal t) const
 				    { evalString(s, "agentname", 0, t); }
@@ -86,6 +114,7 @@ private:
 
 private:
     GU_AgentDefinitionPtr    myDefinition;
+    SOP_BouncyAgentKey	     myDefinitionKey;
     UT_Array<GU_PrimPacked*> myPrims;
 };
 
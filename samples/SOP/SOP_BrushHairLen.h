@@ -30,6 +30,8 @@
 
 #include <SOP/SOP_Node.h>
 #include <SOP/SOP_BrushBase.h>
+#include <GEO/GEO_PointTree.h>
+#include <UT/UT_Array.h>
 
 namespace HDK_Sample {
 class SOP_BrushHairLen : public SOP_BrushBase
@@ -402,6 +404,26 @@ protected:
     virtual void	doErase();
 
 private:
+    /// Whether to build a polygon for each hair, rather than only
+    /// updating the hairlen attribute.
+    int			BUILDHAIR(fpreal t)
+	{ return evalInt("buildhair", 0, t); }
+
+    /// Appends a tip point and a two point polygon for every guide root.
+    void		buildHair(const GA_RWHandleF &hairlen);
+    /// Moves the tips of the hairs whose length no longer matches
+    /// myRootLen, and copies the root's hairlen to any tip whose hairlen
+    /// differs from it.  If points is given, only the hairs of those roots
+    /// or tips are checked, otherwise all of them are.  Returns true if
+    /// any tip changed.
+    bool		updateHair(const GA_RWHandleF &hairlen,
+			    const UT_Array<GA_Offset> *points);
+    /// Appends the roots within the stencil of the dab at myRayHit to
+    /// points, finding them through myRootTree, which is rebuilt first
+    /// if the points of input have changed since it was built.
+    void		findDabbedRoots(const GU_Detail *input, fpreal t,
+			    UT_Array<GA_Offset> &points);
+
     /// Here we cache the current ray hit values...
     UT_Vector3		myRayOrient, myRayHit;
     float		myRayHitU, myRayHitV, myRayHitW;
@@ -418,6 +440,24 @@ private:
     bool		myHairlenFound;
     GA_RWHandleF	myHairlenHandle;
     fpreal		myTime;
+
+    /// The hair length that each guide root's tip was last placed with,
+    /// indexed by root point number.  Its size is the number of roots
+    /// when hair has been built, and 0 otherwise.
+    UT_Array<fpreal32>	myRootLen;
+    /// Tips are one contiguous block of points, in root order.
+    GA_Offset		myTipStart;
+    /// Set when buildHair() has changed our topology since the brush last
+    /// saw it, so that the next cook tells the brush to start over.
+    bool		myHairBuilt;
+    /// The points whose hairlen brushOpCallback() has set this cook.
+    UT_Array<GA_Offset>	myBrushedPoints;
+    /// Spatial index of the input points, which are our guide roots, and
+    /// the input unique id and data IDs that it was built from.
+    GEO_PointTreeGAOffset myRootTree;
+    int			myRootTreeId;
+    GA_DataId		myRootTreeTopologyId;
+    GA_DataId		myRootTreePId;
 };
 } // End HDK_Sample namespace
 
@@ -28,9 +28,12 @@
 #ifndef __SOP_CopRaster_h__
 #define __SOP_CopRaster_h__
 
+#include <UT/UT_Array.h>
+#include <UT/UT_Map.h>
 #include <UT/UT_String.h>
 #include <IMG/IMG_Raster.h>
 #include <SOP/SOP_Node.h>
+#include <SYS/SYS_Hash.h>
 
 namespace HDK_Sample {
 class SOP_CopRaster : public SOP_Node
@@ -43,10 +46,27 @@ public:
     static void	buildColorMenu(void *data, PRM_Name *, int,
 				const PRM_SpareData *, const PRM_Parm *);
 
+    /// Statistics of the raster cache since the node was created.
+    exint	getCacheHits() const	{ return myCacheHits; }
+    exint	getCacheMisses() const	{ return myCacheMisses; }
+    exint	getCacheBytes() const	{ return myCacheBytes; }
+
 protected:
 	     SOP_CopRaster(OP_Network*, const char *, OP_Operator*);
     virtual ~SOP_CopRaster();
 
+    /// Adds a copy of the current image to the raster cache under the given
+    /// key, and makes the copy the current image.  Least recently used
+    /// images are evicted to stay within the budget.  The pixels hash is
+    /// only computed once, and is shared with the cook.  Nothing is copied
+    /// or hashed if the image doesn't fit the budget.
+    void	cacheRaster(SYS_HashType key, exint budget);
+    /// Makes the cached image with the given key current, if there is one.
+    bool	useCachedRaster(SYS_HashType key);
+    void	trimCache(exint budget);
+    void	clearCache();
+    void	writeCacheStats();
+
     virtual OP_ERROR		 cookMySop(OP_Context &context);
 
     virtual bool	 updateParmsFlags();
@@ -63,12 +83,58 @@ protected:
 
 private:
     int			updateRaster(fpreal t);
+    SYS_HashType	hashPixels() const;
+    /// Hashes the current image the first time it's asked for.
+    SYS_HashType	getPixelsHash();
 
     UT_String		myCurrentName;
+    UT_String		myRasterName;	// File loaded into myRaster
     int                 myPrevXRes;
     int                 myPrevYRes;
+    SYS_HashType	myPrevHash;
     IMG_Raster		myRaster;
 
+    // The pixels of the current image, set by updateRaster().  They are
+    // either in myRaster, or in a raster owned by the COP resolver that is
+    // read in place, so they are only valid during the cook.  Pixels are
+    // 8 bit or 32 bit float components, with myComponents per pixel and
+    // rows myStride bytes apart.
+    const unsigned char	*myPixels;
+    int			 myXRes;
+    int			 myYRes;
+    exint		 myStride;
+    int			 myComponents;
+    bool		 myFloatPixels;
+    bool		 myHasPixelsHash;	// myPixelsHash is known
+    SYS_HashType	 myPixelsHash;
+
+    // Images seen on earlier cooks, so that scrubbing back to a frame
+    // doesn't have to fetch its image again.  They are found by key
+    // through a map, and also kept on a list from the most to the least
+    // recently used, so that both lookups and evictions take constant time.
+    struct sop_CachedRaster
+    {
+	SYS_HashType		 myKey;
+	SYS_HashType		 myPixelsHash;
+	UT_Array<unsigned char>	 myPixels;
+	int			 myXRes;
+	int			 myYRes;
+	exint			 myStride;
+	int			 myComponents;
+	bool			 myFloatPixels;
+	sop_CachedRaster	*myPrev;	// More recently used
+	sop_CachedRaster	*myNext;	// Less recently used
+    };
+    void	linkCacheEntry(sop_CachedRaster *entry);
+    void	unlinkCacheEntry(sop_CachedRaster *entry);
+
+    UT_Map<SYS_HashType, sop_CachedRaster *> myCache;
+    sop_CachedRaster	*myCacheHead;	// Most recently used
+    sop_CachedRaster	*myCacheTail;	// Least recently used
+    exint		 myCacheHits;
+    exint		 myCacheMisses;
+    exint		 myCacheBytes;
+
     int		USEDISK()			
 		{ return evalInt("usedisk", 0, 0); }
     void	COPPATH(UT_String &str, fpreal t)
@@ -79,6 +145,8 @@ private:
 		{ evalString(str, "file", 0, t); }
     fpreal	COPFRAME(fpreal t)		
 		{ return evalFloat("copframe", 0, t); }
+    fpreal	CACHESIZE(fpreal t)
+		{ return evalFloat("cachesize", 0, t); }
 };
 } // End HDK_Sample namespace
 
@@ -30,8 +30,11 @@
 
 #include <SOP/SOP_Node.h>
 #include <UT/UT_Array.h>
+#include <UT/UT_BitArray.h>
 
 namespace HDK_Sample {
+class SOP_CustomBrushTree;
+
 enum
 {
     // Group parameters
@@ -120,6 +123,12 @@ private:
     int getEvent(fpreal t)
 	{ return evalInt(SOP_CUSTOMBRUSH_EVENT_IDX, 0, t); }
 
+    // make myDataIndex map each of the 'npts' points to its paint
+    void buildDataIndex(GA_Size npts);
+
+    // forget the paint values remembered for undoing the current stroke
+    void clearOldData();
+
     const GA_PointGroup *myGroup;
 
     // expected number of points in the input
@@ -133,6 +142,24 @@ private:
 
     // contains previous paint values for undos
     UT_Array<SOP_CustomBrushData> myOldData;
+
+    // for each point number, the index of its paint in myData or -1 if no
+    // paint has been applied to it
+    UT_Array<exint> myDataIndex;
+
+    // marks the point numbers that have an entry in myOldData
+    UT_BitArray myOldDataMarked;
+
+    // spatial index of the input points, used to find the points under the
+    // brush without testing every point
+    SOP_CustomBrushTree *myTree;
+
+    // points whose paint changed since our last cook
+    UT_Array<GA_Index> myTouched;
+
+    // true if the color of every painted point must be written on the next
+    // cook, rather than only those in myTouched
+    bool myRewriteAll;
 };
 } // End HDK_Sample namespace
 
@@ -30,8 +30,36 @@
 #define __SOP_DualStar_h__
 
 #include <SOP/SOP_Node.h>
+#include <GU/GU_DetailHandle.h>
+#include <UT/UT_Vector3.h>
 
 namespace HDK_Sample {
+
+/// The evaluated parameters that a star is built from. Both outputs share
+/// the star built for one set of these.
+class SOP_DualStarParms
+{
+public:
+    bool	operator==(const SOP_DualStarParms &p) const
+		{
+		    return myDivisions == p.myDivisions &&
+			   myXRadius == p.myXRadius &&
+			   myYRadius == p.myYRadius &&
+			   myNegRadius == p.myNegRadius &&
+			   myCenter == p.myCenter &&
+			   myOrient == p.myOrient;
+		}
+    bool	operator!=(const SOP_DualStarParms &p) const
+		{ return !(*this == p); }
+
+    int		myDivisions;
+    fpreal	myXRadius;
+    fpreal	myYRadius;
+    int		myNegRadius;
+    UT_Vector3	myCenter;
+    int		myOrient;
+};
+
 class SOP_DualStar : public SOP_Node
 {
 public:
@@ -52,9 +80,10 @@ protected:
     virtual OP_ERROR		 cookMySop(OP_Context &context);
     virtual GU_DetailHandle	 cookMySopOutput(OP_Context &context, int outputidx, SOP_Node *interest);
 
-    /// Actually build a star in the given geometry
-    void	buildStar(GU_Detail *dst,
-			OP_Context &context);
+    /// Make myStar hold the star for the current parameters. Its topology
+    /// is only rebuilt when the number of divisions changes; otherwise only
+    /// the positions are set. Returns false if interrupted.
+    bool	updateStar(OP_Context &context);
 
 private:
     /// The following list of accessors simplify evaluating the parameters
@@ -67,6 +96,17 @@ private:
     fpreal	CENTERY(fpreal t) 	{ return evalFloat("t", 1, t); }
     fpreal	CENTERZ(fpreal t) 	{ return evalFloat("t", 2, t); }
     int		ORIENT()		{ return evalInt  ("orient", 0, 0); }
+
+    /// A star polygon with unset positions, with myTopologyDivisions
+    /// points. Each new star is copied from it.
+    GU_DetailHandle	myTopology;
+    int			myTopologyDivisions;
+
+    /// The star for myStarParms, shared by both outputs. A new detail is
+    /// allocated when the parameters change, rather than changing this one,
+    /// as the second output may still be using it.
+    GU_DetailHandle	myStar;
+    SOP_DualStarParms	myStarParms;
 };
 } // End HDK_Sample namespace
 
@@ -63,6 +63,17 @@ protected:
     ///	not have to be defined.
     virtual OP_ERROR             cookMyGuide1(OP_Context &context);
 
+    /// We don't define any local variables of our own; this only records
+    /// that a parameter referenced one, i.e. that it may vary per point.
+    virtual bool		 evalVariableValue(
+				    fpreal &val,
+				    int index,
+				    int thread);
+    virtual bool		 evalVariableValue(
+				    UT_String &val,
+				    int index,
+				    int thread);
+
 private:
     void	getGroups(UT_String &str){ evalString(str, "group", 0, 0); }
     fpreal	DIST(fpreal t)		{ return evalFloat("dist", 0, t); }
@@ -72,9 +83,15 @@ private:
     fpreal	NY(fpreal t)		{ return evalFloat("dir", 1, t); }
     fpreal	NZ(fpreal t)		{ return evalFloat("dir", 2, t); }
 
+    /// Evaluate the plane to flatten onto for the current point.
+    void	evalPlane(fpreal t, UT_Vector3 &normal, float &dist);
+
     /// This is the group of geometry to be manipulated by this SOP and cooked
     /// by the method "cookInputGroups".
     const GA_PointGroup *myGroup;
+
+    /// Set by evalVariableValue() whenever a local variable is evaluated.
+    bool		 myUsedLocalVar;
 };
 } // End HDK_Sample namespace
 
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2015
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of Houdini Development Kit samples in source and
+ * binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *----------------------------------------------------------------------------
+ * A hash table of item indices, built in parallel by counting sort.  It is
+ * shared by the SOPs that look up many items by a hashed key.
+ */
+
+#ifndef __SOP_HashBuckets_h__
+#define __SOP_HashBuckets_h__
+
+#include <UT/UT_Array.h>
+#include <UT/UT_ParallelUtil.h>
+#include <SYS/SYS_AtomicInt.h>
+#include <SYS/SYS_Types.h>
+
+#include <algorithm>
+
+namespace HDK_Sample {
+
+/// Buckets the items [0, n) by the hash of their keys.  The table has at
+/// least twice as many buckets as items, and the items are counting sorted
+/// by bucket, so building it is linear in the number of items.  Clearing
+/// the counts, counting, scattering and sorting the buckets all run in
+/// parallel; the prefix sum over the counts is the only serial pass.
+/// Different keys can share a bucket, so searches must compare the keys.
+class SOP_HashBuckets
+{
+public:
+    SOP_HashBuckets()
+	: myCursor(NULL)
+	, myCursorSize(0)
+	, myMask(0)
+    {}
+    ~SOP_HashBuckets()
+    {
+	delete [] myCursor;
+    }
+
+    /// Builds the table over the items [0, n).  hash(i, h) sets h to the
+    /// hash of item i's key and returns true, or returns false to leave
+    /// item i out of the table.  It is called from several threads.
+    template <typename HASH>
+    void build(exint n, const HASH &hash);
+
+    exint bucketOf(uint h) const { return exint(h & myMask); }
+
+    /// The items in a bucket are the entries [begin, end) of items(), in
+    /// increasing order.
+    exint bucketBegin(exint b) const { return myStart(b); }
+    exint bucketEnd(exint b) const { return myStart(b+1); }
+    const exint *items() const { return mySorted.array(); }
+    exint entries() const { return mySorted.entries(); }
+
+private:
+    // Not copyable
+    SOP_HashBuckets(const SOP_HashBuckets &);
+    SOP_HashBuckets &operator=(const SOP_HashBuckets &);
+
+    /// Zeroes the count of each bucket.
+    class Clear
+    {
+    public:
+	Clear(SOP_HashBuckets &table) : myTable(table) {}
+
+	void operator()(const UT_BlockedRange<exint> &r) const
+	{
+	    for (exint b = r.begin(); b < r.end(); ++b)
+		myTable.myCursor[b].relaxedStore(0);
+	}
+
+    private:
+	SOP_HashBuckets	&myTable;
+    };
+
+    /// Finds the bucket of each item and counts the items in each bucket.
+    template <typename HASH>
+    class Count
+    {
+    public:
+	Count(SOP_HashBuckets &table, const HASH &hash)
+	    : myTable(table), myHash(hash) {}
+
+	void operator()(const UT_BlockedRange<exint> &r) const
+	{
+	    for (exint i = r.begin(); i < r.end(); ++i)
+	    {
+		uint h;
+		if (!myHash(i, h))
+		{
+		    myTable.myBucket(i) = -1;
+		    continue;
+		}
+		exint b = myTable.bucketOf(h);
+		myTable.myBucket(i) = b;
+		myTable.myCursor[b].add(1);
+	    }
+	}
+
+    private:
+	SOP_HashBuckets	&myTable;
+	const HASH	&myHash;
+    };
+
+    /// Writes each item into the next free slot of its bucket.
+    class Scatter
+    {
+    public:
+	Scatter(SOP_HashBuckets &table) : myTable(table) {}
+
+	void operator()(const UT_BlockedRange<exint> &r) const
+	{
+	    for (exint i = r.begin(); i < r.end(); ++i)
+	    {
+		exint b = myTable.myBucket(i);
+		if (b >= 0)
+		    myTable.mySorted(myTable.myCursor[b].exchangeAdd(1)) = i;
+	    }
+	}
+
+    private:
+	SOP_HashBuckets	&myTable;
+    };
+
+    /// The order that threads fill a bucket in is arbitrary, so each bucket
+    /// is sorted to make the result independent of the thread count.
+    class SortBuckets
+    {
+    public:
+	SortBuckets(SOP_HashBuckets &table) : myTable(table) {}
+
+	void operator()(const UT_BlockedRange<exint> &r) const
+	{
+	    exint *sorted = myTable.mySorted.array();
+	    for (exint b = r.begin(); b < r.end(); ++b)
+	    {
+		exint start = myTable.myStart(b), end = myTable.myStart(b+1);
+		if (end - start > 1)
+		    std::sort(sorted + start, sorted + end);
+	    }
+	}
+
+    private:
+	SOP_HashBuckets	&myTable;
+    };
+
+    SYS_AtomicInt32	*myCursor;	// Per bucket count, then insert slot
+    exint		 myCursorSize;
+    UT_Array<exint>	 myStart;	// First sorted entry of each bucket
+    UT_Array<exint>	 myBucket;	// Bucket of each item
+    UT_Array<exint>	 mySorted;	// Item indices sorted by bucket
+    exint		 myMask;
+};
+
+template <typename HASH>
+void
+SOP_HashBuckets::build(exint n, const HASH &hash)
+{
+    exint nbuckets = 1024;
+    while (nbuckets < 2*n)
+	nbuckets *= 2;
+    myMask = nbuckets - 1;
+
+    if (myCursorSize < nbuckets)
+    {
+	delete [] myCursor;
+	myCursor = new SYS_AtomicInt32[nbuckets];
+	myCursorSize = nbuckets;
+    }
+    UTparallelForLightItems(UT_BlockedRange<exint>(0, nbuckets),
+			    Clear(*this));
+
+    myBucket.setSizeNoInit(n);
+    UTparallelForLightItems(UT_BlockedRange<exint>(0, n),
+			    Count<HASH>(*this, hash));
+
+    // Turn the counts into the start of each bucket.
+    myStart.setSizeNoInit(nbuckets + 1);
+    exint total = 0;
+    for (exint b = 0; b < nbuckets; ++b)
+    {
+	exint count = myCursor[b].relaxedLoad();
+	myStart(b) = total;
+	myCursor[b].relaxedStore(int32(total));
+	total += count;
+    }
+    myStart(nbuckets) = total;
+
+    mySorted.setSizeNoInit(total);
+    UTparallelForLightItems(UT_BlockedRange<exint>(0, n), Scatter(*this));
+    UTparallelForLightItems(UT_BlockedRange<exint>(0, nbuckets),
+			    SortBuckets(*this));
+}
+
+} // End HDK_Sample namespace
+
+#endif
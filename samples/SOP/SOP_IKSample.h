@@ -29,6 +29,10 @@
  * Demonstrates example use of the Inverse Kinematics (IK) Solver found in the
  * KIN library.
  *
+ * In batch mode, every open polyline of the first input is solved as its own
+ * chain. The goal of the polyline that is primitive number N of the first
+ * input is point number N of the second input.
+ *
  */
 
 
@@ -37,6 +41,8 @@
 
 #include <SOP/SOP_Node.h>
 #include <KIN/KIN_Chain.h>
+#include <GA/GA_Types.h>
+#include <UT/UT_Array.h>
 #include <UT/UT_VectorTypes.h>
 #include <SYS/SYS_Types.h>
 
@@ -44,6 +50,19 @@
 namespace HDK_Sample
 {
 
+/// One chain of a batch solve: the points of a polyline, from its root to
+/// its end, and the rest chain set up from their input positions.
+class SOP_IKSampleChain
+{
+public:
+    /// Primitive number of the polyline, which is also the point number of
+    /// its goal in the second input.
+    GA_Index		 myPrimIndex;
+    UT_Array<GA_Index>	 myPoints;
+    UT_Vector3R		 myRoot;
+    KIN_Chain		 myRest;
+};
+
 class SOP_IKSample : public SOP_Node
 {
 public:
@@ -72,6 +91,14 @@ private:
 
     bool		 setupRestChain();
 
+    /// Cook every polyline of the input as an independent chain.
+    OP_ERROR		 cookBatch(OP_Context &context);
+    /// Rebuild myChains from the polylines of src, unless its topology and
+    /// positions are the same as when they were last built. Returns true if
+    /// they were rebuilt.
+    bool		 updateChains(const GU_Detail &src);
+    void		 clearChains();
+
     void		 GOAL(fpreal t, UT_Vector3R &goal) const
 				{       evalFloats("goal", goal.data(), t); }
     fpreal		 TWIST(fpreal t) const
@@ -82,9 +109,22 @@ private:
 				{ return   evalInt("straighten", 0, t); }
     fpreal		 THRESHOLD(fpreal t) const
 				{ return evalFloat("threshold", 0, t); }
+    int			 BATCH(fpreal t) const
+				{ return   evalInt("batch", 0, t); }
 
 private:
     KIN_Chain		 myRestChain;
+
+    /// The chains of batch mode, and the data IDs of the input that they
+    /// were set up from.
+    UT_Array<SOP_IKSampleChain *> myChains;
+    int			 myChainsDetailId;
+    GA_DataId		 myChainsTopologyId;
+    GA_DataId		 myChainsPrimitiveId;
+    GA_DataId		 myChainsPId;
+    /// Number of polylines skipped because they were too short or shared
+    /// points with an earlier chain.
+    exint		 mySkippedChains;
 };
 
 } // End HDK_Sample namespace
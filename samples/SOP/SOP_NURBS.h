@@ -29,6 +29,11 @@
 #define __SOP_NURBS_h__
 
 #include <SOP/SOP_Node.h>
+#include <GA/GA_Types.h>
+#include <UT/UT_Array.h>
+#include <SYS/SYS_Types.h>
+
+class GA_Basis;
 
 namespace HDK_Sample {
 /// @brief Shows the interface for building a NURBS surface
@@ -57,6 +62,82 @@ private:
     int		UORDER(fpreal t)    { return evalInt  ("order", 0, t); }
     int		VORDER(fpreal t)    { return evalInt  ("order", 1, t); }
 };
+
+/// Basis functions of one parametric direction of a surface, evaluated at
+/// every sample of a tessellation. For each sample, myFirstCV is the index
+/// of the first CV that it depends on, and myValues and myDerivs hold the
+/// order values and first derivatives of the basis functions of that CV and
+/// the ones after it.
+class SOP_NURBSBasisTable
+{
+public:
+    /// Evaluate the basis at the given number of samples, spread evenly over
+    /// its valid interval. When wrapped, the end of the interval isn't
+    /// sampled, as it is the same as the start.
+    void		build(const GA_Basis &basis, int samples, bool wrapped);
+
+    int			entries() const { return myFirstCV.entries(); }
+
+    int			myOrder;
+    UT_Array<int>	myFirstCV;
+    UT_Array<fpreal64>	myValues;
+    UT_Array<fpreal64>	myDerivs;
+};
+
+/// A NURBS surface of the input and the polygon mesh it is tessellated into.
+class SOP_NURBSPatch
+{
+public:
+    /// Hull of the surface, as point offsets of the input in row order.
+    UT_Array<GA_Offset>	myHull;
+    int			myRows;
+    int			myCols;
+    /// Offset of the first point of the mesh. The mesh points are in row
+    /// order, one row per sample of myVTable.
+    GA_Offset		myStart;
+    SOP_NURBSBasisTable	myUTable;
+    SOP_NURBSBasisTable	myVTable;
+};
+
+/// @brief Tessellates the NURBS surfaces of its input into polygon meshes
+///
+/// The basis functions are evaluated once into tables, so when only the
+/// CVs of the input change, each cook just sums the tabled basis values
+/// against the new CVs, in parallel.
+class SOP_NURBSTessellate : public SOP_Node
+{
+public:
+    static OP_Node		*myConstructor(OP_Network*, const char *,
+							    OP_Operator *);
+    static PRM_Template		 myTemplateList[];
+
+protected:
+	     SOP_NURBSTessellate(OP_Network *net, const char *name,
+				 OP_Operator *op);
+    virtual ~SOP_NURBSTessellate();
+
+    virtual OP_ERROR		 cookMySop(OP_Context &context);
+    virtual const char		*inputLabel(unsigned idx) const;
+
+private:
+    /// Rebuild the basis tables and output meshes for the surfaces of src.
+    void	buildPatches(const GU_Detail &src, int udivs, int vdivs);
+
+    int		UDIVS(fpreal t)	    { return evalInt  ("divs", 0, t); }
+    int		VDIVS(fpreal t)	    { return evalInt  ("divs", 1, t); }
+
+    UT_Array<SOP_NURBSPatch>	myPatches;
+
+    /// What myPatches were built from, so that they are only rebuilt when
+    /// the surfaces of the input change, rather than just their CVs.
+    int				myDetailId;
+    GA_DataId			myTopologyId;
+    GA_DataId			myPrimitiveId;
+    GA_DataId			myPId;
+    GA_DataId			myPwId;
+    int				myUDivs;
+    int				myVDivs;
+};
 } // End HDK_Sample namespace
 
 #endif
@@ -31,6 +31,9 @@
 #define __SOP_PointWave_h__
 
 #include <SOP/SOP_Node.h>
+#include <GA/GA_OffsetList.h>
+#include <UT/UT_Array.h>
+#include <UT/UT_Vector3.h>
 
 namespace HDK_Sample {
 /// Run a sin() wave through geometry by deforming points
@@ -56,14 +59,28 @@ protected:
     virtual OP_ERROR		 cookMySop(OP_Context &context);
 
 private:
-    void	getGroups(UT_String &str){ evalString(str, "group", 0, 0); }
+    void	getGroups(UT_String &str, fpreal t)
+		{ evalString(str, "group", 0, t); }
     fpreal	AMP(fpreal t)		{ return evalFloat("amp", 0, t); }
     fpreal	PHASE(fpreal t)		{ return evalFloat("phase", 0, t); }
     fpreal	PERIOD(fpreal t)	{ return evalFloat("period", 0, t); }
 
+    /// The points deformed by the last cook, from the cached group.
+    GA_Range	getCachedRange() const;
+
     /// This is the group of geometry to be manipulated by this SOP and cooked
     /// by the method "cookInputGroups".
     const GA_PointGroup *myGroup;
+
+    /// Rest state cached from the input, so that when only time or the
+    /// wave parameters change, the cook only rewrites P.  The rest
+    /// positions are indexed by point offset.  The cache is rebuilt
+    /// whenever duplicateChangedSource() reports the input changed.
+    UT_Array<UT_Vector3F> myRestP;
+    UT_String		 myCachedGroup;
+    GA_OffsetList	 myCachedOffsets;
+    bool		 myCachedAll;
+    bool		 myCacheValid;
 };
 } // End HDK_Sample namespace
 
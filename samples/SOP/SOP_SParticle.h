@@ -32,6 +32,10 @@
 #define __SOP_SParticle_h__
 
 #include <SOP/SOP_Node.h>
+#include <GU/GU_Detail.h>
+#include <UT/UT_Array.h>
+#include <UT/UT_Vector3.h>
+#include <SYS/SYS_Hash.h>
 
 #define INT_PARM(name, idx, vidx, t)	\
 	    return evalInt(name, &myOffsets[idx], vidx, t);
@@ -58,10 +62,11 @@ protected:
     virtual const char          *inputLabel(unsigned idx) const;
 
     void		birthParticle();
-    int			moveParticle(GA_Offset ptoff,
-				     const UT_Vector3 &force);
 
     void		initSystem();
+    void		writeParticles();
+    void		writeStats();
+    void		updateCollision(const GU_Detail *collision);
     void		timeStep(fpreal now);
 
     // Method to cook geometry for the SOP
@@ -77,17 +82,99 @@ private:
     fpreal		 FX(fpreal t)	{ FLT_PARM("force", 1, 0, t) }
     fpreal		 FY(fpreal t)	{ FLT_PARM("force", 1, 1, t) }
     fpreal		 FZ(fpreal t)	{ FLT_PARM("force", 1, 2, t) }
+    int			 MINSUBSTEPS(fpreal t)
+			    { INT_PARM("minsubsteps", 3, 0, t) }
+    int			 MAXSUBSTEPS(fpreal t)
+			    { INT_PARM("maxsubsteps", 4, 0, t) }
+    fpreal		 CFL(fpreal t)	{ FLT_PARM("cfl", 5, 0, t) }
+    int			 USECACHE()	{ INT_PARM("usecache", 6, 0, 0) }
+    void		 CACHEDIR(UT_String &str)
+			    { evalString(str, "cachedir", &myOffsets[7], 0, 0); }
+    int			 INTERACT()	{ INT_PARM("interact", 8, 0, 0) }
+    fpreal		 RADIUS(fpreal t)
+			    { FLT_PARM("radius", 9, 0, t) }
+    fpreal		 SEPARATION(fpreal t)
+			    { FLT_PARM("separation", 10, 0, t) }
+    fpreal		 COHESION(fpreal t)
+			    { FLT_PARM("cohesion", 11, 0, t) }
+    fpreal		 ALIGNMENT(fpreal t)
+			    { FLT_PARM("alignment", 12, 0, t) }
+
+    // On-disk cache of the particle state at the end of each frame, so
+    // that cooking an earlier frame can resume from the nearest snapshot
+    // instead of simulating from the reset frame.
+    void		 getSnapshotPath(UT_String &path, const UT_String &dir,
+					 exint frame);
+    void		 updateSourceHash();
+    void		 updateCacheKeys(exint reset, exint frame);
+    bool		 saveSnapshot(exint frame, SYS_HashType key);
+    bool		 loadSnapshot(exint frame, SYS_HashType key);
 
     const GU_Detail	*mySource;
     GA_Index		 mySourceNum;		// Source point to birth from
     GA_ROHandleV3	 mySourceVel;		// Velocity attrib in source
 
+    // The snapshot keys hash the contents of the inputs, since unique ids
+    // and data IDs only mean something within one session and snapshots
+    // outlive it.  The source is only rehashed when its data IDs change.
+    SYS_HashType	 mySourceHash;
+    exint		 mySourceUniqueId;
+    GA_DataId		 mySourceTopologyId;
+    GA_DataId		 mySourcePId;
+    GA_DataId		 mySourceVelId;
+
+    // Keys of the frames from the reset frame on, kept between cooks and
+    // only extended as later frames are needed.  They are cleared when a
+    // simulation parameter changes or the inputs hash differently.
+    UT_Array<SYS_HashType> myCacheKeys;
+    SYS_HashType	 myCacheKeysBase;
+
+    // The collision structure is kept between cooks, built over our own
+    // copy of the collision input, and only rebuilt when that input's
+    // data IDs change.  Once built, it is only queried, so it can be
+    // shared by all threads moving particles.
     GU_RayIntersect	*myCollision;
+    GU_Detail		 myCollisionGdp;
+    exint		 myCollisionUniqueId;
+    GA_DataId		 myCollisionTopologyId;
+    GA_DataId		 myCollisionPrimitiveId;
+    GA_DataId		 myCollisionPId;
+    fpreal		 myCollisionFeatureSize; // Shortest collider edge
+    SYS_HashType	 myCollisionHash;	// Contents of the collider
 
     GEO_PrimParticle	*mySystem;
     fpreal		 myLastCookTime;	// Last cooked time
     GA_RWHandleV3	 myVelocity;		// My velocity attribute
     GA_RWHandleF	 myLife;		// My life attribute
+    GA_RWHandleI	 myId;			// My birth id attribute
+
+    // The particle state is kept between cooks as structure-of-arrays,
+    // one entry per living particle, and advanced in parallel.  It is
+    // only copied into the particle system at the end of each cook.
+    UT_Array<UT_Vector3F> myPos;
+    UT_Array<UT_Vector3F> myVel;
+    UT_Array<float>	 myAge;
+    UT_Array<float>	 myLifeSpan;
+    UT_Array<exint>	 myIds;
+    UT_Array<char>	 myAlive;		// Scratch for timeStep()
+    UT_Array<UT_Vector3F> myAccel;		// Scratch for timeStep()
+    exint		 myNextId;		// Birth id of the next particle
+
+    // Substep statistics for the frames stepped by the current cook.
+    struct sop_SubstepStats
+    {
+	sop_SubstepStats()
+	    : myFrames(0), myTotalSubsteps(0), myMinSubsteps(0)
+	    , myMaxSubsteps(0), myLastSubsteps(0), myMaxSpeed(0) {}
+
+	exint	myFrames;
+	exint	myTotalSubsteps;
+	int	myMinSubsteps;
+	int	myMaxSubsteps;
+	int	myLastSubsteps;
+	fpreal	myMaxSpeed;
+    };
+    sop_SubstepStats	 myStats;
 
     static int		*myOffsets;
 };
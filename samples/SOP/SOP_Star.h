@@ -67,7 +67,7 @@ protected:
 				    int i,
 				    int thread)
 				 {
-				     return evalVariableValue(v, i, thread);
+				     return SOP_Node::evalVariableValue(v, i, thread);
 				 }
 
 private:
@@ -88,6 +88,10 @@ private:
     /// Another use for local data is a cache to store expensive calculations.
     int		myCurrPoint;
     int		myTotalPoints;
+
+    /// Set when the $PT local variable is evaluated, so that we can tell
+    /// whether the radii differ from point to point.
+    bool	myUsedPointVariable;
 };
 } // End HDK_Sample namespace
 
@@ -32,8 +32,42 @@ that the
 #define __SOP_Surface_h__
 
 #include <SOP/SOP_Node.h>
+#include <GA/GA_Types.h>
+#include <UT/UT_Array.h>
+#include <UT/UT_Map.h>
+#include <SYS/SYS_Hash.h>
+
+class GU_Detail;
 
 namespace HDK_Sample {
+
+/// What one tile of the volume added to the output when it was last
+/// surfaced, so that it can be taken out again when the tile changes.
+class SOP_SurfaceTile
+{
+public:
+    SOP_SurfaceTile() : myHash(0), myValid(false) {}
+
+    /// The primitives built from the tile's cells.
+    UT_Array<GA_Offset>	myPrims;
+    /// The points that only the tile's primitives use.
+    UT_Array<GA_Offset>	myPoints;
+    /// The keys of the points on seams with other tiles that the tile's
+    /// primitives use, which are shared through SOP_Surface::mySeams.
+    UT_Array<exint>	mySeams;
+    /// The hash of the tile's voxels when it was surfaced.
+    SYS_HashType	myHash;
+    bool		myValid;
+};
+
+/// A point on the seam between tiles, and how many tiles use it.
+class SOP_SurfaceSeam
+{
+public:
+    GA_Offset		myPoint;
+    int			myRefs;
+};
+
 class SOP_Surface : public SOP_Node
 {
 public:
@@ -53,6 +87,30 @@ protected:
 private:
     fpreal  ISO(fpreal t)   { return evalFloat("iso", 0, t); }
     bool BUILDPOLYSOUP(fpreal t) { return evalInt("buildpolysoup", 0, t) != 0; }
+
+    void    clearCache();
+    /// Destroys the primitives and points that tile i added to gdp.
+    void    removeTile(exint i);
+    /// Merges the polygons that tile i was surfaced into, if any, into gdp,
+    /// sharing its points on seams with the tiles already there.  The keys
+    /// of those points are appended to seams.  Returns the number of points
+    /// on seams that couldn't be shared.
+    exint   addTile(exint i, const GU_Detail *tilegdp, SYS_HashType hash,
+		    const UT_Vector3 &pos, const UT_Vector3 &size,
+		    const int *res, UT_Array<exint> &seams);
+
+    /// What each tile added to gdp, and the points on the seams between
+    /// them keyed by the voxel corner or edge they're on.  Only the tiles
+    /// that changed since the last cook are surfaced again and replaced.
+    UT_Array<SOP_SurfaceTile>	    myTiles;
+    UT_Map<exint, SOP_SurfaceSeam>  mySeams;
+    /// The hash of the other inputs that the polygons were built from.
+    SYS_HashType		    mySettingsHash;
+    /// The gdp that the tiles were added to, with the number of points and
+    /// primitives it was left with, to tell if it's still as we left it.
+    int				    myGdpId;
+    GA_Size			    myNumPoints;
+    GA_Size			    myNumPrims;
 };
 } // End HDK_Sample namespace
 
@@ -34,7 +34,8 @@
 
 namespace HDK_Sample {
 /// Compares a point attribute on the two inputs at different times, storing
-/// the difference in a new attribute.
+/// the difference in a new attribute.  Points are matched by index, or by
+/// an integer id attribute when the point count changes over time.
 class SOP_TimeCompare : public SOP_Node
 {
 public:
@@ -64,6 +65,10 @@ private:
 		{ evalString(str, "resultattrib", 0, t); }
     fpreal	FRAME(fpreal t)
 		{ return evalFloat("frame", 0, t); }
+    bool	MATCHBYID(fpreal t)
+		{ return evalInt("matchbyid", 0, t) != 0; }
+    void	IDATTRIB(UT_String &str, fpreal t)
+		{ evalString(str, "idattrib", 0, t); }
 
     /// This is the group of geometry to be manipulated by this SOP and cooked
     /// by the method "cookInputGroups".